@@ -0,0 +1,89 @@
+//======== Copyright (c) 2023, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph benchmark
+//
+// $NoKeywords: $ivs_project_1 $tdd_benchmark.cpp
+// $Author:     Maksym Podhornyi <xpodho08@stud.fit.vutbr.cz>
+// $Date:       $2023-03-07
+//============================================================================//
+/**
+ * @file tdd_benchmark.cpp
+ * @author Maksym Podhornyi
+ *
+ * @brief Mereni vlivu Graph::reorderNodes na barveni a pruchod grafem.
+ *
+ * Graf je mrizka side x side, jejiz hrany jsou vkladany v nahodnem poradi, takze sousedni uzly
+ * lezi v m_nodes daleko od sebe. Meri se cesty, ktere pracuji s indexy uzlu (coloringAsync,
+ * validateColoring), pred a po preusporadani. Graph::coloring() se preusporadanim nezrychli.
+ *
+ * Preklad: g++ -std=c++17 -O2 tdd_benchmark.cpp tdd_code.cpp -pthread -o tdd_benchmark
+ * Spusteni: ./tdd_benchmark [side] [repeats]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "tdd_code.h"
+
+static void inlineExecutor(std::function<void()> task) {
+    task();
+}
+
+template <typename F>
+static double measure(size_t repeats, F fn) {
+    double best = 0;
+    for (size_t i = 0; i < repeats; i++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = (i == 0) ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+static void run(Graph& graph, const char* label, size_t repeats) {
+    double coloring = measure(repeats, [&]() { graph.coloringAsync(inlineExecutor).get(); });
+    double traversal = measure(repeats, [&]() { graph.validateColoring(); });
+    std::printf("%-22s coloringAsync %8.1f ms   validateColoring %8.1f ms\n", label, coloring, traversal);
+}
+
+int main(int argc, char* argv[]) {
+    size_t side = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 700;
+    size_t repeats = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 3;
+
+    std::vector<Edge> edges;
+    for (size_t y = 0; y < side; y++) {
+        for (size_t x = 0; x < side; x++) {
+            size_t id = y * side + x;
+            if (x + 1 < side) {
+                edges.push_back(Edge(id, id + 1));
+            }
+            if (y + 1 < side) {
+                edges.push_back(Edge(id, id + side));
+            }
+        }
+    }
+    std::shuffle(edges.begin(), edges.end(), std::mt19937(42));
+
+    Graph graph;
+    Graph::Batch batch = graph.batch();
+    for (const auto& edge : edges) {
+        batch.addEdge(edge);
+    }
+    batch.commit();
+
+    std::printf("%zu nodes, %zu edges\n", graph.nodeCount(), graph.edgeCount());
+
+    run(graph, "insertion order", repeats);
+    graph.reorderNodes(NodeOrdering::DEGREE_DESCENDING);
+    run(graph, "degree descending", repeats);
+    graph.reorderNodes(NodeOrdering::REVERSE_CUTHILL_MCKEE);
+    run(graph, "reverse Cuthill-McKee", repeats);
+
+    return 0;
+}
+
+/*** Konec souboru tdd_benchmark.cpp ***/
@@ -16,6 +16,267 @@
 
 #include "tdd_code.h"
 #include "algorithm"
+#include <unordered_map>
+#include <random>
+#include <thread>
+#include <queue>
+#include <limits>
+#include <cstdint>
+
+namespace {
+
+    size_t edgeKeyHash(const Edge& edge){
+        size_t lo = std::min(edge.a, edge.b);
+        size_t hi = std::max(edge.a, edge.b);
+        return std::hash<size_t>()(lo) ^ (std::hash<size_t>()(hi) + 0x9e3779b97f4a7c15ULL + (lo << 6) + (lo >> 2));
+    }
+
+    struct EdgeKeyHasher{
+        size_t operator()(const Edge& edge) const { return edgeKeyHash(edge); }
+    };
+
+    /**
+     * Odhad režie alokátoru pro jednu alokaci dané velikosti. Známa je jen pro glibc, jinak 0.
+     */
+    size_t mallocOverhead(size_t bytes){
+
+#ifdef __GLIBC__
+        // glibc: k požadavku přidá hlavičku size_t, zarovná na 2 * size_t a alokuje nejméně 4 * size_t
+        const size_t alignment = 2 * sizeof(size_t);
+        size_t chunk = std::max(4 * sizeof(size_t), (bytes + sizeof(size_t) + alignment - 1) / alignment * alignment);
+        return chunk - bytes;
+#else
+        (void) bytes;
+        return 0;
+#endif
+    }
+
+    typedef std::vector<std::vector<size_t>> Adjacency;
+
+    /**
+     * Označí hrany, jejichž koncové uzly mají stejnou nenulovou barvu. Smyčka je bez větvení,
+     * aby ji překladač mohl vektorizovat.
+     */
+    template <typename Color>
+    void markConflicts(const Color* colorsA, const Color* colorsB, unsigned char* out, size_t count){
+
+        for (size_t i = 0; i < count; i++){
+            out[i] = (colorsA[i] == colorsB[i]) & (colorsA[i] != 0);
+        }
+    }
+
+    /**
+     * Hladové barvení v daném pořadí uzlů. Barvy jsou číslovány od 0.
+     * Funkce step se volá s počtem obarvených uzlů po každých 1024 uzlech, pokud vrátí false,
+     * barvení skončí a výsledkem je prázdný vektor.
+     */
+    std::vector<size_t> greedyColors(const Adjacency& adj, const std::vector<size_t>& order,
+                                     const std::function<bool(size_t)>& step = nullptr){
+
+        const size_t noColor = adj.size();
+        std::vector<size_t> colors(adj.size(), noColor);
+        std::vector<size_t> usedBy(adj.size() + 1, noColor);
+        size_t done = 0;
+
+        for (auto v : order){
+            for (auto u : adj[v]){
+                if (colors[u] != noColor){
+                    usedBy[colors[u]] = v;
+                }
+            }
+            size_t color = 0;
+            while (usedBy[color] == v){
+                color++;
+            }
+            colors[v] = color;
+
+            if (step && (++done & 0x3ff) == 0 && !step(done)){
+                return std::vector<size_t>();
+            }
+        }
+
+        return colors;
+    }
+
+    size_t colorCount(const std::vector<size_t>& colors){
+
+        size_t count = 0;
+        for (auto color : colors){
+            count = std::max(count, color + 1);
+        }
+        return count;
+    }
+
+    /**
+     * Iterované hladové barvení: uzly seřadí po barevných třídách a obarví znovu.
+     * Výsledek nikdy nepoužije více barev než vstup.
+     */
+    std::vector<size_t> iteratedGreedy(const Adjacency& adj, const std::vector<size_t>& colors, std::mt19937& rng){
+
+        size_t k = colorCount(colors);
+        std::vector<std::vector<size_t>> classes(k);
+        for (size_t v = 0; v < colors.size(); v++){
+            classes[colors[v]].push_back(v);
+        }
+
+        switch (rng() % 3){
+            case 0:
+                std::reverse(classes.begin(), classes.end());
+                break;
+            case 1:
+                std::stable_sort(classes.begin(), classes.end(),
+                                 [](const std::vector<size_t>& x, const std::vector<size_t>& y){
+                                     return x.size() > y.size();
+                                 });
+                break;
+            default:
+                std::shuffle(classes.begin(), classes.end(), rng);
+                break;
+        }
+
+        std::vector<size_t> order;
+        order.reserve(colors.size());
+        for (const auto& colorClass : classes){
+            order.insert(order.end(), colorClass.begin(), colorClass.end());
+        }
+
+        return greedyColors(adj, order);
+    }
+
+    /**
+     * Pracovní pole TabuCol sdílená mezi koly, aby se n * k tabulky nealokovaly v každém kole.
+     */
+    struct TabuState{
+        size_t k = 0;  ///< počet barev, pro který jsou pole alokována
+        uint64_t clock = 0;  ///< počet tahů všech předchozích kol se stejným k
+        std::vector<uint32_t> gamma;  ///< gamma[v * k + c] je počet sousedů v s barvou c
+        std::vector<uint64_t> tabu;  ///< tabu[v * k + c] je tah, do kterého je přesun v do c zakázán
+    };
+
+    /**
+     * TabuCol: hledá obarvení k barvami bez konfliktů. Vychází z obarvení colors,
+     * uzly s barvou >= k přebarví náhodně. Při úspěchu uloží výsledek do colors.
+     */
+    bool tabuCol(const Adjacency& adj, std::vector<size_t>& colors, size_t k, size_t maxMoves,
+                 std::mt19937& rng, const std::function<bool()>& shouldStop, TabuState& state){
+
+        const size_t n = adj.size();
+        std::vector<size_t> sol(colors);
+        for (auto& color : sol){
+            if (color >= k){
+                color = rng() % k;
+            }
+        }
+
+        if (state.k != k){
+            state.k = k;
+            state.clock = 0;
+            state.gamma.assign(n * k, 0);
+            state.tabu.assign(n * k, 0);
+        } else {
+            std::fill(state.gamma.begin(), state.gamma.end(), 0);
+        }
+
+        // tabu hodnoty z předchozích kol jsou menší než clock, a tedy neplatné
+        std::vector<uint32_t>& gamma = state.gamma;
+        std::vector<uint64_t>& tabu = state.tabu;
+        const uint64_t clock = state.clock;
+        size_t conflicts = 0;
+
+        // seznam uzlů v konfliktu, slot[v] je pozice v seznamu nebo n
+        std::vector<size_t> conflicting;
+        std::vector<size_t> slot(n, n);
+        auto updateConflict = [&](size_t v){
+            bool inConflict = gamma[v * k + sol[v]] > 0;
+            if (inConflict && slot[v] == n){
+                slot[v] = conflicting.size();
+                conflicting.push_back(v);
+            } else if (!inConflict && slot[v] != n){
+                size_t last = conflicting.back();
+                conflicting[slot[v]] = last;
+                slot[last] = slot[v];
+                conflicting.pop_back();
+                slot[v] = n;
+            }
+        };
+
+        for (size_t v = 0; v < n; v++){
+            for (auto u : adj[v]){
+                gamma[v * k + sol[u]]++;
+                if (u > v && sol[u] == sol[v]){
+                    conflicts++;
+                }
+            }
+        }
+
+        for (size_t v = 0; v < n; v++){
+            updateConflict(v);
+        }
+
+        size_t move = 1;
+        for (; conflicts > 0 && move <= maxMoves; move++){
+            if ((move & 0xff) == 0 && shouldStop()){
+                break;
+            }
+            const uint64_t now = clock + move;
+
+            long bestDelta = 0;
+            size_t bestVertex = n;
+            size_t bestColor = 0;
+            size_t ties = 0;
+
+            for (auto v : conflicting){
+                size_t current = gamma[v * k + sol[v]];
+                for (size_t c = 0; c < k; c++){
+                    if (c == sol[v]){
+                        continue;
+                    }
+                    long delta = static_cast<long>(gamma[v * k + c]) - static_cast<long>(current);
+                    bool aspiration = static_cast<long>(conflicts) + delta == 0;
+                    if (tabu[v * k + c] >= now && !aspiration){
+                        continue;
+                    }
+                    if (bestVertex == n || delta < bestDelta){
+                        bestDelta = delta;
+                        bestVertex = v;
+                        bestColor = c;
+                        ties = 1;
+                    } else if (delta == bestDelta && rng() % ++ties == 0){
+                        bestVertex = v;
+                        bestColor = c;
+                    }
+                }
+            }
+
+            if (bestVertex == n){
+                continue;
+            }
+
+            size_t oldColor = sol[bestVertex];
+            for (auto u : adj[bestVertex]){
+                gamma[u * k + oldColor]--;
+                gamma[u * k + bestColor]++;
+            }
+            sol[bestVertex] = bestColor;
+            for (auto u : adj[bestVertex]){
+                updateConflict(u);
+            }
+            updateConflict(bestVertex);
+            conflicts = static_cast<size_t>(static_cast<long>(conflicts) + bestDelta);
+            tabu[bestVertex * k + oldColor] = now + rng() % 10 + conflicts * 6 / 10;
+        }
+
+        state.clock += move;
+
+        if (conflicts != 0){
+            return false;
+        }
+
+        colors.swap(sol);
+        return true;
+    }
+
+}
 
 
 Graph::Graph(){
@@ -110,6 +371,7 @@ void Graph::removeNode(size_t nodeId) {
 
     for (auto it = m_nodes.begin(); it != m_nodes.end(); it++) {
         if ((*it)->id == nodeId) {
+            delete *it;
             m_nodes.erase(it);
             nodeFound = true;
             break;
@@ -120,12 +382,9 @@ void Graph::removeNode(size_t nodeId) {
         throw std::out_of_range("Node with given id does not exist in the graph.");
     }
 
-    for (auto it = m_edges.begin(); it != m_edges.end(); it++) {
-        if ((*it).a == nodeId || (*it).b == nodeId) {
-            m_edges.erase(it);
-            it--;
-        }
-    }
+    m_edges.erase(std::remove_if(m_edges.begin(), m_edges.end(),
+                                 [nodeId](const Edge& e) { return e.a == nodeId || e.b == nodeId; }),
+                  m_edges.end());
 
 }
 
@@ -219,6 +478,380 @@ void Graph::coloring(){
     }
 }
 
+size_t Graph::improveColoring(const ColoringBudget& budget){
+
+    if (budget.maxIterations == 0 && budget.timeLimit.count() <= 0 && budget.cancel == nullptr){
+        throw std::invalid_argument("Coloring budget has no limit");
+    }
+
+    if (m_nodes.empty()){
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto shouldStop = [&](){
+        if (budget.cancel != nullptr && budget.cancel->load()){
+            return true;
+        }
+        return budget.timeLimit.count() > 0 && std::chrono::steady_clock::now() - start >= budget.timeLimit;
+    };
+
+    Adjacency adj = adjacency();
+    std::mt19937 rng(budget.seed);
+
+    std::vector<size_t> order(m_nodes.size());
+    for (size_t i = 0; i < order.size(); i++){
+        order[i] = i;
+    }
+
+    std::vector<size_t> current = greedyColors(adj, order);
+    size_t best = colorCount(current);
+
+    auto publish = [&](bool improved){
+        for (size_t i = 0; i < m_nodes.size(); i++){
+            m_nodes[i]->color = current[i] + 1;
+        }
+        if (improved && budget.onImprove){
+            budget.onImprove(best);
+        }
+    };
+
+    publish(false);
+
+    size_t lowerBound = m_edges.empty() ? 1 : 2;
+    const size_t movesPerRound = 10000;
+    TabuState tabuState;
+
+    for (size_t iteration = 0; best > lowerBound; iteration++){
+        if ((budget.maxIterations != 0 && iteration >= budget.maxIterations) || shouldStop()){
+            break;
+        }
+
+        std::vector<size_t> candidate = iteratedGreedy(adj, current, rng);
+        if (colorCount(candidate) <= best){
+            current.swap(candidate);
+            if (colorCount(current) < best){
+                best = colorCount(current);
+                publish(true);
+                continue;
+            }
+        }
+
+        if (tabuCol(adj, current, best - 1, movesPerRound, rng, shouldStop, tabuState)){
+            best = colorCount(current);
+            publish(true);
+        }
+    }
+
+    return best;
+
+}
+
+std::future<bool> Graph::coloringAsync(const ColoringExecutor& executor, std::shared_ptr<ColoringControl> control){
+
+    if (!executor){
+        throw std::invalid_argument("Executor is not set");
+    }
+
+    if (!control){
+        control = std::make_shared<ColoringControl>();
+    }
+
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+
+    executor([this, promise, control](){
+        try {
+            size_t total = m_nodes.size();
+            control->colored = 0;
+            control->total = total;
+
+            auto step = [&](size_t done){
+                control->colored = done;
+                if (control->onProgress){
+                    control->onProgress(done, total);
+                }
+                return !control->cancelled.load();
+            };
+
+            if (!step(0)){
+                promise->set_value(false);
+                return;
+            }
+
+            std::vector<size_t> order(total);
+            for (size_t i = 0; i < total; i++){
+                order[i] = i;
+            }
+
+            std::vector<size_t> colors = greedyColors(adjacency(), order, step);
+            if (colors.size() != total || control->cancelled.load()){
+                promise->set_value(false);
+                return;
+            }
+
+            for (size_t i = 0; i < total; i++){
+                m_nodes[i]->color = colors[i] + 1;
+            }
+
+            step(total);
+            promise->set_value(true);
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return result;
+
+}
+
+ColoringReport Graph::validateColoring(const ColoringExecutor& executor, size_t chunks) const{
+
+    ColoringReport report;
+
+    std::unordered_map<size_t, size_t> positionOf;
+    positionOf.reserve(m_nodes.size());
+    std::vector<size_t> colors(m_nodes.size());
+    size_t maxColor = 0;
+    for (size_t i = 0; i < m_nodes.size(); i++){
+        positionOf[m_nodes[i]->id] = i;
+        colors[i] = m_nodes[i]->color;
+        maxColor = std::max(maxColor, colors[i]);
+    }
+
+    report.classSizes.assign(maxColor + 1, 0);
+    for (auto color : colors){
+        report.classSizes[color]++;
+    }
+    report.uncolored = report.classSizes[0];
+    report.colorCount = std::count_if(report.classSizes.begin() + 1, report.classSizes.end(),
+                                      [](size_t size){ return size != 0; });
+
+    const size_t edgeCount = m_edges.size();
+    if (chunks == 0){
+        const size_t minChunk = 1 << 16;
+        chunks = std::max<size_t>(1, std::thread::hardware_concurrency());
+        chunks = std::max<size_t>(1, std::min(chunks, edgeCount / minChunk));
+    } else {
+        chunks = std::min(chunks, std::max<size_t>(1, edgeCount));
+    }
+    if (!executor){
+        chunks = 1;
+    }
+
+    // positionOf a colors se už jen čtou, bloky k nim tedy mohou přistupovat souběžně
+    std::vector<unsigned char> conflict(edgeCount);
+    auto gatherAndMark = [&](auto colorType, size_t from, size_t to){
+        typedef decltype(colorType) Color;
+        const size_t count = to - from;
+        const Edge* edges = m_edges.data() + from;
+
+        std::vector<Color> colorsA(count);
+        std::vector<Color> colorsB(count);
+        for (size_t i = 0; i < count; i++){
+            colorsA[i] = static_cast<Color>(colors[positionOf.at(edges[i].a)]);
+            colorsB[i] = static_cast<Color>(colors[positionOf.at(edges[i].b)]);
+        }
+
+        markConflicts(colorsA.data(), colorsB.data(), conflict.data() + from, count);
+    };
+
+    // 32bitové barvy umožní vektorizaci porovnání i bez SSE4.1
+    const bool narrowColors = maxColor <= std::numeric_limits<uint32_t>::max();
+    auto kernel = [&](size_t from, size_t to){
+        if (narrowColors){
+            gatherAndMark(uint32_t(), from, to);
+        } else {
+            gatherAndMark(size_t(), from, to);
+        }
+    };
+
+    size_t chunk = (edgeCount + chunks - 1) / chunks;
+    std::vector<std::future<void>> pending;
+    for (size_t t = 1; t < chunks; t++){
+        size_t from = std::min(edgeCount, t * chunk);
+        size_t to = std::min(edgeCount, (t + 1) * chunk);
+        auto promise = std::make_shared<std::promise<void>>();
+        auto started = std::make_shared<std::atomic<bool>>(false);
+        pending.push_back(promise->get_future());
+
+        std::function<void()> task = [&kernel, promise, started, from, to](){
+            if (started->exchange(true)){
+                return;
+            }
+            try {
+                kernel(from, to);
+                promise->set_value();
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        };
+
+        try {
+            executor(task);
+        } catch (...) {
+            task();
+        }
+    }
+
+    std::exception_ptr error;
+    try {
+        kernel(0, std::min(edgeCount, chunk));
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    for (auto& result : pending){
+        result.wait();
+    }
+    if (error){
+        std::rethrow_exception(error);
+    }
+    for (auto& result : pending){
+        result.get();
+    }
+
+    for (size_t i = 0; i < edgeCount; i++){
+        if (conflict[i]){
+            report.conflicts.push_back(m_edges[i]);
+        }
+    }
+
+    report.valid = report.conflicts.empty() && report.uncolored == 0;
+    return report;
+
+}
+
+GraphMemoryUsage Graph::memoryUsage() const{
+
+    GraphMemoryUsage usage;
+
+    usage.graph = sizeof(Graph);
+    usage.nodes = m_nodes.size() * sizeof(Node);
+    usage.edges = m_edges.size() * sizeof(Edge);
+    usage.nodePointers = m_nodes.size() * sizeof(Node*);
+    usage.capacitySlack = (m_nodes.capacity() - m_nodes.size()) * sizeof(Node*)
+                          + (m_edges.capacity() - m_edges.size()) * sizeof(Edge);
+    usage.allocatorOverhead = m_nodes.size() * mallocOverhead(sizeof(Node));
+    if (m_nodes.capacity() != 0){
+        usage.allocatorOverhead += mallocOverhead(m_nodes.capacity() * sizeof(Node*));
+    }
+    if (m_edges.capacity() != 0){
+        usage.allocatorOverhead += mallocOverhead(m_edges.capacity() * sizeof(Edge));
+    }
+
+    return usage;
+
+}
+
+void Graph::compact(){
+
+    m_nodes.shrink_to_fit();
+    m_edges.shrink_to_fit();
+
+}
+
+void Graph::reorderNodes(NodeOrdering ordering){
+
+    Adjacency adj = adjacency();
+    const size_t n = adj.size();
+
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++){
+        order[i] = i;
+    }
+
+    auto byDegree = [&adj](size_t x, size_t y){ return adj[x].size() < adj[y].size(); };
+
+    if (ordering == NodeOrdering::DEGREE_DESCENDING){
+        std::stable_sort(order.begin(), order.end(),
+                         [&adj](size_t x, size_t y){ return adj[x].size() > adj[y].size(); });
+    } else {
+        // každá komponenta začíná uzlem s nejmenším stupněm
+        std::vector<size_t> seeds(order);
+        std::stable_sort(seeds.begin(), seeds.end(), byDegree);
+
+        std::vector<bool> visited(n, false);
+        std::vector<size_t> neighbors;
+        order.clear();
+
+        for (auto seed : seeds){
+            if (visited[seed]){
+                continue;
+            }
+            std::queue<size_t> queue;
+            queue.push(seed);
+            visited[seed] = true;
+
+            while (!queue.empty()){
+                size_t v = queue.front();
+                queue.pop();
+                order.push_back(v);
+
+                neighbors.clear();
+                for (auto u : adj[v]){
+                    if (!visited[u]){
+                        visited[u] = true;
+                        neighbors.push_back(u);
+                    }
+                }
+                std::stable_sort(neighbors.begin(), neighbors.end(), byDegree);
+                for (auto u : neighbors){
+                    queue.push(u);
+                }
+            }
+        }
+
+        std::reverse(order.begin(), order.end());
+    }
+
+    std::vector<Node*> nodes(n);
+    std::unordered_map<size_t, size_t> positionOf;
+    positionOf.reserve(n);
+    for (size_t i = 0; i < n; i++){
+        nodes[i] = m_nodes[order[i]];
+        positionOf[nodes[i]->id] = i;
+    }
+
+    std::vector<std::pair<std::pair<size_t, size_t>, size_t>> keys(m_edges.size());
+    for (size_t i = 0; i < m_edges.size(); i++){
+        size_t a = positionOf[m_edges[i].a];
+        size_t b = positionOf[m_edges[i].b];
+        keys[i] = {{std::min(a, b), std::max(a, b)}, i};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<Edge> edges;
+    edges.reserve(m_edges.size());
+    for (const auto& key : keys){
+        edges.push_back(m_edges[key.second]);
+    }
+
+    m_nodes.swap(nodes);
+    m_edges.swap(edges);
+
+}
+
+std::vector<std::vector<size_t>> Graph::adjacency() const{
+
+    std::unordered_map<size_t, size_t> position;
+    position.reserve(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); i++){
+        position[m_nodes[i]->id] = i;
+    }
+
+    std::vector<std::vector<size_t>> adj(m_nodes.size());
+    for (const auto& edge : m_edges){
+        size_t a = position.at(edge.a);
+        size_t b = position.at(edge.b);
+        adj[a].push_back(b);
+        adj[b].push_back(a);
+    }
+
+    return adj;
+
+}
+
 void Graph::clear() {
 
     for (auto node : m_nodes){
@@ -230,4 +863,195 @@ void Graph::clear() {
 
 }
 
+Graph::Batch Graph::batch(){
+
+    return Batch(*this);
+
+}
+
+Graph::Batch::Batch(Graph& graph) : m_graph(&graph) {}
+
+Graph::Batch::Batch(Batch&& other) noexcept : m_graph(other.m_graph), m_ops(std::move(other.m_ops)) {
+
+    other.m_ops.clear();
+
+}
+
+Graph::Batch::~Batch(){
+
+    rollback();
+
+}
+
+Graph::Batch& Graph::Batch::addNode(size_t nodeId){
+
+    m_ops.push_back({OpType::ADD_NODE, Edge(nodeId, nodeId)});
+    return *this;
+
+}
+
+Graph::Batch& Graph::Batch::addEdge(const Edge& edge){
+
+    m_ops.push_back({OpType::ADD_EDGE, edge});
+    return *this;
+
+}
+
+Graph::Batch& Graph::Batch::removeNode(size_t nodeId){
+
+    m_ops.push_back({OpType::REMOVE_NODE, Edge(nodeId, nodeId)});
+    return *this;
+
+}
+
+Graph::Batch& Graph::Batch::removeEdge(const Edge& edge){
+
+    m_ops.push_back({OpType::REMOVE_EDGE, edge});
+    return *this;
+
+}
+
+size_t Graph::Batch::size() const{
+
+    return m_ops.size();
+
+}
+
+void Graph::Batch::rollback(){
+
+    m_ops.clear();
+
+}
+
+void Graph::Batch::commit(){
+
+    if (m_ops.empty()){
+        return;
+    }
+
+    struct NodeSlot{
+        size_t id;
+        Node* node;  // nullptr pro uzly vytvořené touto transakcí
+        bool alive;
+    };
+
+    struct EdgeSlot{
+        Edge edge;
+        bool alive;
+    };
+
+    std::vector<Node*>& graphNodes = m_graph->m_nodes;
+    std::vector<Edge>& graphEdges = m_graph->m_edges;
+
+    std::vector<NodeSlot> nodes;
+    std::vector<EdgeSlot> edges;
+    std::unordered_map<size_t, size_t> nodeIndex;
+    std::unordered_map<Edge, size_t, EdgeKeyHasher> edgeIndex;
+    std::unordered_map<size_t, std::vector<size_t>> incident;
+
+    nodes.reserve(graphNodes.size());
+    edges.reserve(graphEdges.size());
+    nodeIndex.reserve(graphNodes.size());
+    edgeIndex.reserve(graphEdges.size());
+
+    for (auto node : graphNodes){
+        nodeIndex[node->id] = nodes.size();
+        nodes.push_back({node->id, node, true});
+    }
+
+    for (const auto& edge : graphEdges){
+        edgeIndex[edge] = edges.size();
+        incident[edge.a].push_back(edges.size());
+        incident[edge.b].push_back(edges.size());
+        edges.push_back({edge, true});
+    }
+
+    auto insertNode = [&](size_t nodeId){
+        if (nodeIndex.find(nodeId) == nodeIndex.end()){
+            nodeIndex[nodeId] = nodes.size();
+            nodes.push_back({nodeId, nullptr, true});
+        }
+    };
+
+    for (const auto& op : m_ops){
+        switch (op.type){
+            case OpType::ADD_NODE:
+                insertNode(op.edge.a);
+                break;
+
+            case OpType::ADD_EDGE:
+                if (op.edge.a == op.edge.b || edgeIndex.find(op.edge) != edgeIndex.end()){
+                    break;
+                }
+                insertNode(op.edge.a);
+                insertNode(op.edge.b);
+                edgeIndex[op.edge] = edges.size();
+                incident[op.edge.a].push_back(edges.size());
+                incident[op.edge.b].push_back(edges.size());
+                edges.push_back({op.edge, true});
+                break;
+
+            case OpType::REMOVE_NODE: {
+                auto it = nodeIndex.find(op.edge.a);
+                if (it == nodeIndex.end()){
+                    throw std::out_of_range("Node with given id does not exist in the graph.");
+                }
+                nodes[it->second].alive = false;
+                nodeIndex.erase(it);
+
+                auto inc = incident.find(op.edge.a);
+                if (inc != incident.end()){
+                    for (auto slot : inc->second){
+                        if (edges[slot].alive){
+                            edges[slot].alive = false;
+                            edgeIndex.erase(edges[slot].edge);
+                        }
+                    }
+                    incident.erase(inc);
+                }
+                break;
+            }
+
+            case OpType::REMOVE_EDGE: {
+                // removeEdge hledá hranu jen ve stejné orientaci, v jaké byla vložena
+                auto it = edgeIndex.find(op.edge);
+                if (it == edgeIndex.end() || edges[it->second].edge.a != op.edge.a
+                    || edges[it->second].edge.b != op.edge.b){
+                    throw std::out_of_range("Edge does not exist");
+                }
+                edges[it->second].alive = false;
+                edgeIndex.erase(it);
+                break;
+            }
+        }
+    }
+
+    std::vector<Node*> newNodes;
+    newNodes.reserve(nodeIndex.size());
+    for (auto& slot : nodes){
+        if (slot.alive){
+            newNodes.push_back(slot.node != nullptr ? slot.node : new Node(slot.id));
+        }
+    }
+
+    std::vector<Edge> newEdges;
+    newEdges.reserve(edgeIndex.size());
+    for (const auto& slot : edges){
+        if (slot.alive){
+            newEdges.push_back(slot.edge);
+        }
+    }
+
+    for (const auto& slot : nodes){
+        if (!slot.alive){
+            delete slot.node;
+        }
+    }
+
+    graphNodes.swap(newNodes);
+    graphEdges.swap(newEdges);
+    m_ops.clear();
+
+}
+
 /*** Konec souboru tdd_code.cpp ***/
@@ -21,6 +21,11 @@
 #include <vector>
 #include <stdexcept>
 #include <iostream>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
 
 
 /**
@@ -80,6 +85,81 @@ public:
     }
 };
 
+/**
+ * @brief Omezení běhu Graph::improveColoring.
+ *
+ * Optimalizace skončí, jakmile je vyčerpán kterýkoliv z nastavených limitů.
+ * Alespoň jeden limit (počet iterací, čas nebo příznak zrušení) musí být nastaven.
+ */
+struct ColoringBudget{
+    size_t maxIterations = 1000;  ///< maximální počet iterací, 0 znamená bez omezení
+    std::chrono::milliseconds timeLimit{1000};  ///< maximální doba běhu, 0 znamená bez omezení
+    const std::atomic<bool>* cancel = nullptr;  ///< příznak zrušení, může být nullptr
+    std::function<void(size_t)> onImprove;  ///< volá se s počtem barev po každém nalezení obarvení lepšího než výchozí hladové
+    unsigned seed = 0;  ///< semínko generátoru náhodných čísel
+};
+
+/**
+ * @brief Průběh a zrušení asynchronního barvení spuštěného přes Graph::coloringAsync.
+ *
+ * Čítače lze číst z libovolného vlákna, onProgress se volá ve vlákně exekutoru.
+ */
+struct ColoringControl{
+    std::atomic<bool> cancelled{false};  ///< po nastavení na true barvení skončí bez zápisu barev
+    std::atomic<size_t> colored{0};  ///< počet již obarvených uzlů
+    std::atomic<size_t> total{0};  ///< celkový počet uzlů k obarvení
+    std::function<void(size_t, size_t)> onProgress;  ///< volá se s hodnotami (colored, total)
+
+    /**
+     * @brief Požádá o zrušení barvení.
+     */
+    void cancel() { cancelled = true; }
+};
+
+/**
+ * @brief Exekutor, kterému Graph::coloringAsync předá úlohu ke spuštění (např. fronta thread poolu).
+ */
+typedef std::function<void(std::function<void()>)> ColoringExecutor;
+
+/**
+ * @brief Výsledek kontroly obarvení, viz Graph::validateColoring.
+ */
+struct ColoringReport{
+    bool valid = true;  ///< true pokud jsou všechny uzly obarveny a žádná hrana nespojuje stejné barvy
+    std::vector<Edge> conflicts;  ///< hrany, jejichž oba uzly mají stejnou nenulovou barvu
+    size_t uncolored = 0;  ///< počet neobarvených uzlů (barva 0)
+    size_t colorCount = 0;  ///< počet různých použitých barev
+    std::vector<size_t> classSizes;  ///< classSizes[c] je počet uzlů s barvou c, index 0 jsou neobarvené uzly
+};
+
+/**
+ * @brief Paměť obsazená grafem v bajtech, viz Graph::memoryUsage.
+ *
+ * Režie alokátoru se odhaduje jen s glibc (hlavička a zarovnání každého uzlu a obou polí),
+ * s jinými alokátory není známa a allocatorOverhead je 0.
+ */
+struct GraphMemoryUsage{
+    size_t graph = 0;  ///< samotný objekt grafu (sizeof(Graph))
+    size_t nodes = 0;  ///< objekty uzlů (sizeof(Node) na uzel)
+    size_t edges = 0;  ///< použitá část pole hran
+    size_t nodePointers = 0;  ///< použitá část pole ukazatelů na uzly (m_nodes)
+    size_t capacitySlack = 0;  ///< alokovaná, ale nevyužitá kapacita polí uzlů a hran
+    size_t allocatorOverhead = 0;  ///< odhad režie alokátoru glibc pro uzly a obě pole, jinak 0
+
+    /**
+     * @return součet všech složek
+     */
+    size_t total() const { return graph + nodes + edges + nodePointers + capacitySlack + allocatorOverhead; }
+};
+
+/**
+ * @brief Pořadí uzlů pro Graph::reorderNodes.
+ */
+enum class NodeOrdering{
+    DEGREE_DESCENDING,  ///< uzly seřazené sestupně podle stupně
+    REVERSE_CUTHILL_MCKEE  ///< obrácené Cuthill-McKee pořadí, sousední uzly leží blízko sebe
+};
+
 /**
  * @brief Třída reprezentující neorientovaný graf bez smyček.
  *
@@ -197,12 +277,172 @@ public:
      */
     void coloring();
 
+    /**
+     * Obarví graf hladovým algoritmem a poté se v rámci daného rozpočtu snaží snížit počet použitých barev.
+     * Střídá iterované hladové barvení (přeuspořádání barevných tříd) a lokální prohledávání TabuCol
+     * nad obarvením s o jednu barvou méně.
+     *
+     * Atribut color uzlů obsahuje po celou dobu běhu nejlepší dosud nalezené platné obarvení,
+     * takže zrušení nebo vyčerpání rozpočtu je nechá v konzistentním stavu.
+     *
+     * @param[in] budget omezení počtu iterací, času a příznak zrušení
+     * @return počet barev nejlepšího nalezeného obarvení
+     * @exception invalid_argument pokud budget nemá nastaven žádný limit
+     */
+    size_t improveColoring(const ColoringBudget& budget = ColoringBudget());
+
+    /**
+     * Naplánuje barvení grafu na daný exekutor a vrátí future s výsledkem. Nevytváří vlastní vlákna.
+     * Barvy se počítají mimo uzly a do atributu color se zapíší najednou až po dokončení,
+     * zrušené barvení tedy uzly nezmění. Během běhu úlohy se graf nesmí měnit.
+     *
+     * @param[in] executor exekutor, který úlohu spustí
+     * @param[in] control průběh a zrušení, může být nullptr
+     * @return future s hodnotou true, pokud bylo barvení dokončeno, nebo false, pokud bylo zrušeno
+     * @exception invalid_argument pokud executor není nastaven
+     */
+    std::future<bool> coloringAsync(const ColoringExecutor& executor,
+                                    std::shared_ptr<ColoringControl> control = nullptr);
+
+    /**
+     * Zkontroluje obarvení uzlů. Hrany se rozdělí na bloky, první blok zpracuje volající vlákno,
+     * ostatní se předají exekutoru a volání počká na jejich dokončení. Bez exekutoru se všechny bloky
+     * zpracují ve volajícím vlákně. Exekutor nesmí úlohy spouštět pouze ve vlákně, které čeká na výsledek.
+     *
+     * @param[in] executor exekutor pro paralelní kontrolu, může být nullptr
+     * @param[in] chunks počet bloků, 0 znamená podle počtu jader a velikosti grafu
+     * @return konfliktní hrany, počet použitých barev a velikosti barevných tříd
+     */
+    ColoringReport validateColoring(const ColoringExecutor& executor = nullptr, size_t chunks = 0) const;
+
+    /**
+     * @return rozpis paměti obsazené grafem podle složek
+     */
+    GraphMemoryUsage memoryUsage() const;
+
+    /**
+     * Uvolní nevyužitou kapacitu polí uzlů a hran. Ukazatele na uzly zůstávají platné.
+     *
+     * Každé volání obě pole znovu alokuje a zkopíruje (O(n + m)) a zahodí rezervu pro růst,
+     * takže další vkládání pole opět zvětšuje. Vyplatí se volat, až když memoryUsage() hlásí
+     * výraznou capacitySlack, ne po každé změně.
+     */
+    void compact();
+
+    /**
+     * Přeuspořádá interní pole uzlů a hran tak, aby sousední uzly ležely blízko sebe.
+     * Hrany se seřadí podle nových pozic svých uzlů, jejich orientace se nemění.
+     * Id uzlů, ukazatele na uzly i getNode zůstávají platné, mění se pouze pořadí v nodes() a edges().
+     * Samotné objekty uzlů se nepřesouvají.
+     *
+     * Zrychlí metody, které pracují s indexy uzlů (improveColoring, coloringAsync, validateColoring).
+     * coloring(), nodeDegree() a graphDegree() prohledávají uzly a hrany lineárně a zrychlení nepřinese.
+     * Měření je v tdd_benchmark.cpp.
+     *
+     * @param[in] ordering požadované pořadí uzlů
+     */
+    void reorderNodes(NodeOrdering ordering);
+
     /**
      * Smazání všech uzlů a hran v grafu.
      */
     void clear();
 
+    /**
+     * @brief Transakce, která hromadně provádí změny grafu.
+     *
+     * Operace se pouze ukládají do fronty. Až commit() je přehraje nad dočasným indexem uzlů a hran
+     * a graf přepíše jediným průchodem. Výsledný stav odpovídá postupnému volání stejných metod grafu.
+     * Pokud by některá operace vyhodila výjimku, graf zůstane beze změny.
+     * Neodeslané operace se při zániku transakce zahodí.
+     */
+    class Batch{
+    public:
+        /**
+         * @brief Vytvoří prázdnou transakci nad daným grafem.
+         * @param[in, out] graph Graf, do kterého se změny zapíší při commit().
+         */
+        explicit Batch(Graph& graph);
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch(Batch&& other) noexcept;
+
+        /**
+         * @brief Zahodí neodeslané operace.
+         */
+        ~Batch();
+
+        /**
+         * @brief Naplánuje Graph::addNode.
+         * @param[in] nodeId Id uzlu.
+         * @return tato transakce
+         */
+        Batch& addNode(size_t nodeId);
+
+        /**
+         * @brief Naplánuje Graph::addEdge.
+         * @param[in] edge Hrana, která bude přidána.
+         * @return tato transakce
+         */
+        Batch& addEdge(const Edge& edge);
+
+        /**
+         * @brief Naplánuje Graph::removeNode.
+         * @param[in] nodeId Id uzlu, který bude odstraněn.
+         * @return tato transakce
+         */
+        Batch& removeNode(size_t nodeId);
+
+        /**
+         * @brief Naplánuje Graph::removeEdge.
+         * @param[in] edge Hrana, která bude odstraněna.
+         * @return tato transakce
+         */
+        Batch& removeEdge(const Edge& edge);
+
+        /**
+         * @return počet naplánovaných operací
+         */
+        size_t size() const;
+
+        /**
+         * Provede všechny naplánované operace a vyprázdní frontu.
+         *
+         * @exception out_of_range pokud by některá operace při postupném provádění vyhodila out_of_range,
+         *            graf se v takovém případě nezmění a fronta zůstane zachována
+         */
+        void commit();
+
+        /**
+         * Zahodí všechny naplánované operace, graf zůstane beze změny.
+         */
+        void rollback();
+
+    private:
+        enum class OpType { ADD_NODE, ADD_EDGE, REMOVE_NODE, REMOVE_EDGE };
+
+        struct Op{
+            OpType type;
+            Edge edge;  ///< hrana operace, operace nad uzlem používají pouze edge.a
+        };
+
+        Graph* m_graph;
+        std::vector<Op> m_ops;
+    };
+
+    /**
+     * @brief Založí novou transakci nad tímto grafem.
+     * @return prázdná transakce
+     */
+    Batch batch();
+
 protected:
+    /**
+     * @return seznamy sousedů indexované podle pozice uzlu v m_nodes
+     */
+    std::vector<std::vector<size_t>> adjacency() const;
+
     std::vector<Node*> m_nodes;
     std::vector<Edge> m_edges;
 };
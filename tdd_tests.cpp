@@ -0,0 +1,513 @@
+//======== Copyright (c) 2023, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph extensions tests
+//
+// $NoKeywords: $ivs_project_1 $tdd_tests.cpp
+// $Author:     Maksym Podhornyi <xpodho08@stud.fit.vutbr.cz>
+// $Date:       $2023-03-07
+//============================================================================//
+/**
+ * @file tdd_tests.cpp
+ * @author Maksym Podhornyi
+ *
+ * @brief Testy rozsirujiciho rozhrani grafu.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tdd_code.h"
+
+//============================================================================//
+// Testy rozsireni tridy Graph:
+// 1. Hromadne zmeny pres Graph::Batch
+// 2. Vylepsovani, asynchronni barveni a kontrola obarveni
+// 3. Pametova stopa a preusporadani uzlu
+//============================================================================//
+
+class EmptyGraph : public ::testing::Test {
+protected:
+
+    Graph graph;
+
+};
+
+class NonEmptyGraph : public ::testing::Test {
+protected:
+
+    void SetUp() {
+
+        graph.addMultipleEdges({ Edge(1, 2), Edge(2, 3), Edge(3, 1), Edge(3, 4), Edge(4, 5) });
+
+    }
+
+    Graph graph;
+
+};
+
+static std::vector<size_t> nodeIds(Graph& graph) {
+
+    std::vector<size_t> ids;
+    for (auto node : graph.nodes()) {
+        ids.push_back(node->id);
+    }
+    return ids;
+
+}
+
+static std::vector<std::pair<size_t, size_t>> orientedEdges(const Graph& graph) {
+
+    std::vector<std::pair<size_t, size_t>> edges;
+    for (const auto& edge : graph.edges()) {
+        edges.push_back({ edge.a, edge.b });
+    }
+    return edges;
+
+}
+
+TEST_F(EmptyGraph, BatchCommit) {
+
+    Graph::Batch batch = graph.batch();
+    batch.addEdge(Edge(1, 2)).addEdge(Edge(2, 3)).addEdge(Edge(3, 3)).addNode(7);
+
+    EXPECT_EQ(4, batch.size());
+    EXPECT_EQ(0, graph.nodeCount());
+
+    batch.commit();
+
+    EXPECT_EQ(0, batch.size());
+    EXPECT_EQ(4, graph.nodeCount());
+    EXPECT_EQ(2, graph.edgeCount());
+    EXPECT_TRUE(graph.containsEdge(Edge(2, 1)));
+    EXPECT_TRUE(graph.containsEdge(Edge(2, 3)));
+    EXPECT_NE(nullptr, graph.getNode(7));
+
+}
+
+TEST_F(NonEmptyGraph, BatchMatchesSequential) {
+
+    Graph sequential;
+    sequential.addMultipleEdges({ Edge(1, 2), Edge(2, 3), Edge(3, 1), Edge(3, 4), Edge(4, 5) });
+
+    sequential.addEdge(Edge(5, 6));
+    sequential.addEdge(Edge(2, 1));
+    sequential.removeNode(3);
+    sequential.addEdge(Edge(3, 6));
+    sequential.removeEdge(Edge(4, 5));
+    sequential.addNode(1);
+    sequential.addNode(9);
+
+    Graph::Batch batch = graph.batch();
+    batch.addEdge(Edge(5, 6))
+         .addEdge(Edge(2, 1))
+         .removeNode(3)
+         .addEdge(Edge(3, 6))
+         .removeEdge(Edge(4, 5))
+         .addNode(1)
+         .addNode(9);
+    batch.commit();
+
+    EXPECT_EQ(nodeIds(sequential), nodeIds(graph));
+    EXPECT_EQ(orientedEdges(sequential), orientedEdges(graph));
+
+}
+
+TEST_F(NonEmptyGraph, BatchRollback) {
+
+    std::vector<size_t> ids = nodeIds(graph);
+    std::vector<std::pair<size_t, size_t>> edges = orientedEdges(graph);
+
+    Graph::Batch batch = graph.batch();
+    batch.removeNode(1).addEdge(Edge(7, 8));
+    batch.rollback();
+    batch.commit();
+
+    {
+        Graph::Batch discarded = graph.batch();
+        discarded.removeNode(2);
+    }
+
+    EXPECT_EQ(ids, nodeIds(graph));
+    EXPECT_EQ(edges, orientedEdges(graph));
+
+}
+
+TEST_F(NonEmptyGraph, BatchCommitIsAllOrNothing) {
+
+    std::vector<size_t> ids = nodeIds(graph);
+    std::vector<std::pair<size_t, size_t>> edges = orientedEdges(graph);
+    Node* node = graph.getNode(4);
+
+    Graph::Batch batch = graph.batch();
+    batch.addEdge(Edge(10, 11)).removeNode(4).removeNode(4);
+
+    EXPECT_THROW(batch.commit(), std::out_of_range);
+    EXPECT_EQ(3, batch.size());
+    EXPECT_EQ(ids, nodeIds(graph));
+    EXPECT_EQ(edges, orientedEdges(graph));
+    EXPECT_EQ(node, graph.getNode(4));
+
+}
+
+TEST_F(NonEmptyGraph, BatchRemoveEdgeOrientation) {
+
+    Graph::Batch reversed = graph.batch();
+    reversed.removeEdge(Edge(2, 1));
+    EXPECT_THROW(reversed.commit(), std::out_of_range);
+    EXPECT_TRUE(graph.containsEdge(Edge(1, 2)));
+
+    Graph::Batch same = graph.batch();
+    same.removeEdge(Edge(1, 2));
+    same.commit();
+    EXPECT_FALSE(graph.containsEdge(Edge(1, 2)));
+    EXPECT_EQ(4, graph.edgeCount());
+
+}
+
+static bool isProperColoring(Graph& graph) {
+
+    for (const auto& edge : graph.edges()) {
+        if (graph.getNode(edge.a)->color == graph.getNode(edge.b)->color) {
+            return false;
+        }
+    }
+    for (auto node : graph.nodes()) {
+        if (node->color == 0) {
+            return false;
+        }
+    }
+    return true;
+
+}
+
+static size_t maxColor(Graph& graph) {
+
+    size_t result = 0;
+    for (auto node : graph.nodes()) {
+        result = std::max(result, node->color);
+    }
+    return result;
+
+}
+
+TEST_F(EmptyGraph, ImproveColoring) {
+
+    EXPECT_EQ(0, graph.improveColoring());
+
+}
+
+TEST_F(NonEmptyGraph, ImproveColoring) {
+
+    ColoringBudget budget;
+    budget.maxIterations = 20;
+    size_t colors = graph.improveColoring(budget);
+
+    EXPECT_EQ(3, colors);
+    EXPECT_EQ(colors, maxColor(graph));
+    EXPECT_TRUE(isProperColoring(graph));
+
+}
+
+TEST_F(NonEmptyGraph, ImproveColoringBudget) {
+
+    ColoringBudget unlimited;
+    unlimited.maxIterations = 0;
+    unlimited.timeLimit = std::chrono::milliseconds(0);
+    EXPECT_THROW(graph.improveColoring(unlimited), std::invalid_argument);
+
+    std::atomic<bool> cancel(true);
+    unlimited.cancel = &cancel;
+    size_t colors = graph.improveColoring(unlimited);
+
+    EXPECT_EQ(colors, maxColor(graph));
+    EXPECT_TRUE(isProperColoring(graph));
+
+}
+
+TEST_F(EmptyGraph, ImproveColoringCrown) {
+
+    // korunovy graf vlozeny strida strany, takze hladove barveni potrebuje n barev
+    const size_t pairs = 6;
+    for (size_t i = 0; i < 2 * pairs; i++) {
+        graph.addNode(i);
+    }
+    for (size_t i = 0; i < pairs; i++) {
+        for (size_t j = 0; j < pairs; j++) {
+            if (i != j) {
+                graph.addEdge(Edge(2 * i, 2 * j + 1));
+            }
+        }
+    }
+
+    std::vector<size_t> reported;
+    ColoringBudget budget;
+    budget.onImprove = [&reported](size_t colors) { reported.push_back(colors); };
+
+    EXPECT_EQ(2, graph.improveColoring(budget));
+    EXPECT_TRUE(isProperColoring(graph));
+    EXPECT_EQ(2, maxColor(graph));
+
+    ASSERT_FALSE(reported.empty());
+    EXPECT_LT(reported.front(), pairs);
+    EXPECT_EQ(2, reported.back());
+
+}
+
+TEST_F(NonEmptyGraph, ColoringAsync) {
+
+    std::vector<std::function<void()>> queue;
+    ColoringExecutor executor = [&queue](std::function<void()> task) { queue.push_back(task); };
+
+    auto control = std::make_shared<ColoringControl>();
+    std::future<bool> result = graph.coloringAsync(executor, control);
+
+    ASSERT_EQ(1, queue.size());
+    EXPECT_EQ(std::future_status::timeout, result.wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(0, graph.getNode(1)->color);
+
+    queue.front()();
+
+    EXPECT_TRUE(result.get());
+    EXPECT_TRUE(isProperColoring(graph));
+    EXPECT_EQ(graph.nodeCount(), control->total.load());
+    EXPECT_EQ(control->total.load(), control->colored.load());
+
+}
+
+TEST_F(NonEmptyGraph, ColoringAsyncNoExecutor) {
+
+    EXPECT_THROW(graph.coloringAsync(nullptr), std::invalid_argument);
+
+}
+
+TEST_F(EmptyGraph, ColoringAsyncCancel) {
+
+    for (size_t i = 0; i < 5000; i++) {
+        graph.addNode(i);
+    }
+    Graph::Batch batch = graph.batch();
+    for (size_t i = 0; i + 1 < 5000; i++) {
+        batch.addEdge(Edge(i, i + 1));
+    }
+    batch.commit();
+
+    for (auto node : graph.nodes()) {
+        node->color = 7;
+    }
+
+    ColoringExecutor inlineExecutor = [](std::function<void()> task) { task(); };
+
+    auto control = std::make_shared<ColoringControl>();
+    control->onProgress = [&control](size_t colored, size_t) {
+        if (colored >= 1024) {
+            control->cancel();
+        }
+    };
+
+    EXPECT_FALSE(graph.coloringAsync(inlineExecutor, control).get());
+    EXPECT_GE(control->colored.load(), 1024);
+    EXPECT_LT(control->colored.load(), control->total.load());
+
+    for (auto node : graph.nodes()) {
+        EXPECT_EQ(7, node->color);
+    }
+
+}
+
+TEST_F(EmptyGraph, ValidateColoring) {
+
+    ColoringReport report = graph.validateColoring();
+
+    EXPECT_TRUE(report.valid);
+    EXPECT_TRUE(report.conflicts.empty());
+    EXPECT_EQ(0, report.colorCount);
+
+}
+
+TEST_F(NonEmptyGraph, ValidateColoring) {
+
+    ColoringReport uncolored = graph.validateColoring();
+    EXPECT_FALSE(uncolored.valid);
+    EXPECT_TRUE(uncolored.conflicts.empty());
+    EXPECT_EQ(5, uncolored.uncolored);
+
+    graph.getNode(1)->color = 1;
+    graph.getNode(2)->color = 2;
+    graph.getNode(3)->color = 3;
+    graph.getNode(4)->color = 1;
+    graph.getNode(5)->color = 2;
+
+    ColoringReport valid = graph.validateColoring();
+    EXPECT_TRUE(valid.valid);
+    EXPECT_EQ(3, valid.colorCount);
+    EXPECT_EQ(std::vector<size_t>({ 0, 2, 2, 1 }), valid.classSizes);
+
+    graph.getNode(4)->color = 3;
+
+    ColoringReport conflict = graph.validateColoring();
+    EXPECT_FALSE(conflict.valid);
+    ASSERT_EQ(1, conflict.conflicts.size());
+    EXPECT_EQ(Edge(3, 4), conflict.conflicts[0]);
+    EXPECT_EQ(0, conflict.uncolored);
+
+}
+
+TEST_F(EmptyGraph, ValidateColoringChunks) {
+
+    Graph::Batch batch = graph.batch();
+    for (size_t i = 0; i < 20000; i++) {
+        batch.addEdge(Edge(i, i + 1));
+    }
+    batch.commit();
+
+    for (auto node : graph.nodes()) {
+        node->color = node->id % 2 + 1;
+    }
+    graph.getNode(100)->color = graph.getNode(101)->color;
+
+    size_t submitted = 0;
+    ColoringExecutor executor = [&submitted](std::function<void()> task) {
+        submitted++;
+        task();
+    };
+
+    ColoringReport report = graph.validateColoring(executor, 8);
+    EXPECT_EQ(7, submitted);
+    EXPECT_EQ(2, report.conflicts.size());
+
+    size_t offered = 0;
+    ColoringExecutor rejecting = [&offered](std::function<void()> task) {
+        if (offered++ % 2 == 0) {
+            throw std::runtime_error("executor is full");
+        }
+        task();
+    };
+
+    report = graph.validateColoring(rejecting, 4);
+    EXPECT_EQ(3, offered);
+    EXPECT_EQ(2, report.conflicts.size());
+    EXPECT_EQ(report.conflicts, graph.validateColoring().conflicts);
+
+}
+
+TEST_F(NonEmptyGraph, RemoveNodeEdges) {
+
+    graph.removeNode(3);
+
+    EXPECT_EQ(nullptr, graph.getNode(3));
+    EXPECT_EQ(4, graph.nodeCount());
+    EXPECT_EQ(2, graph.edgeCount());
+    EXPECT_TRUE(graph.containsEdge(Edge(1, 2)));
+    EXPECT_TRUE(graph.containsEdge(Edge(4, 5)));
+
+    graph.removeNode(1);
+
+    EXPECT_EQ(1, graph.edgeCount());
+    EXPECT_THROW(graph.removeNode(1), std::out_of_range);
+
+}
+
+TEST_F(EmptyGraph, MemoryUsage) {
+
+    GraphMemoryUsage empty = graph.memoryUsage();
+    EXPECT_EQ(sizeof(Graph), empty.graph);
+    EXPECT_EQ(0, empty.nodes);
+    EXPECT_EQ(0, empty.edges);
+
+    for (size_t i = 0; i < 1000; i++) {
+        graph.addEdge(Edge(i, i + 1));
+    }
+
+    GraphMemoryUsage usage = graph.memoryUsage();
+    EXPECT_EQ(1001 * sizeof(Node), usage.nodes);
+    EXPECT_EQ(1000 * sizeof(Edge), usage.edges);
+    EXPECT_EQ(1001 * sizeof(Node*), usage.nodePointers);
+    EXPECT_EQ(usage.graph + usage.nodes + usage.edges + usage.nodePointers
+              + usage.capacitySlack + usage.allocatorOverhead, usage.total());
+
+}
+
+TEST_F(EmptyGraph, Compact) {
+
+    for (size_t i = 0; i < 1000; i++) {
+        graph.addEdge(Edge(i, i + 1));
+    }
+    for (size_t i = 0; i < 900; i++) {
+        graph.removeNode(i);
+    }
+    Node* node = graph.getNode(950);
+
+    GraphMemoryUsage before = graph.memoryUsage();
+    EXPECT_GT(before.capacitySlack, 0);
+
+    graph.compact();
+
+    GraphMemoryUsage after = graph.memoryUsage();
+    EXPECT_EQ(0, after.capacitySlack);
+    EXPECT_LT(after.total(), before.total());
+    EXPECT_EQ(node, graph.getNode(950));
+    EXPECT_EQ(101, graph.nodeCount());
+    EXPECT_EQ(100, graph.edgeCount());
+
+}
+
+TEST_F(NonEmptyGraph, ReorderNodesDegree) {
+
+    std::vector<std::pair<size_t, size_t>> edges = orientedEdges(graph);
+    Node* node = graph.getNode(3);
+
+    graph.reorderNodes(NodeOrdering::DEGREE_DESCENDING);
+
+    std::vector<Node*> nodes = graph.nodes();
+    ASSERT_EQ(5, nodes.size());
+    EXPECT_EQ(node, nodes.front());
+    for (size_t i = 1; i < nodes.size(); i++) {
+        EXPECT_GE(graph.nodeDegree(nodes[i - 1]->id), graph.nodeDegree(nodes[i]->id));
+    }
+
+    std::vector<std::pair<size_t, size_t>> reordered = orientedEdges(graph);
+    std::sort(edges.begin(), edges.end());
+    std::sort(reordered.begin(), reordered.end());
+    EXPECT_EQ(edges, reordered);
+    EXPECT_EQ(node, graph.getNode(3));
+
+}
+
+TEST_F(EmptyGraph, ReorderNodesCuthillMcKee) {
+
+    // cesta 0 - 1 - ... - 99 vlozena v poradi, ktere sousedy rozhazi
+    const size_t count = 100;
+    for (size_t i = 0; i < count; i++) {
+        graph.addNode((i * 37) % count);
+    }
+    for (size_t i = 0; i + 1 < count; i++) {
+        graph.addEdge(Edge(i, i + 1));
+    }
+
+    graph.reorderNodes(NodeOrdering::REVERSE_CUTHILL_MCKEE);
+
+    std::vector<size_t> position(count);
+    std::vector<size_t> ids = nodeIds(graph);
+    ASSERT_EQ(count, ids.size());
+    for (size_t i = 0; i < count; i++) {
+        position[ids[i]] = i;
+    }
+
+    for (const auto& edge : graph.edges()) {
+        size_t a = position[edge.a];
+        size_t b = position[edge.b];
+        EXPECT_EQ(1, std::max(a, b) - std::min(a, b));
+    }
+    EXPECT_EQ(count - 1, graph.edgeCount());
+    EXPECT_NE(nullptr, graph.getNode(42));
+
+}
+
+/*** Konec souboru tdd_tests.cpp ***/